@@ -3,6 +3,7 @@
 
 #include <SDL2/SDL.h>
 #include "Character.h"
+#include "CombatArbiter.h"
 
 // Forward declaration of Character to avoid circular dependency
 class Character;
@@ -15,12 +16,13 @@ enum AIState {
     AI_FLEE
 };
 
-class AIController {
+class AIController : public AttackTokenListener {
 private:
     Character* character;
     Character* playerCharacter;
     AIState currentState;
     bool isActiveCombatant;  // Flag indicating if this AI is currently engaged in combat
+    CombatArbiter* arbiter;  // Hands out attack turns, optional
     
     // AI behavior parameters
     int detectionRange;
@@ -37,10 +39,12 @@ private:
     Uint32 lastDecisionTime;
     Uint32 decisionDelay;
     Uint32 lastAttackTime;
+    Uint32 lastUpdateTime;  // time passed to the latest update, used when leaving the arbiter
     Uint32 attackCooldown;  // milliseconds between attacks
     
     // Combat parameters
     int attackType;  // 1-4, corresponding to attack animations
+    int threat;      // Higher threat gets attack turns sooner
     
     // Internal decision-making methods
     void makeDecision();
@@ -59,11 +63,19 @@ public:
     void setPatrolSpeed(int speed) { patrolSpeed = speed; }
     void setChaseSpeed(int speed) { chaseSpeed = speed; }
     void setAttackCooldown(Uint32 cooldown) { attackCooldown = cooldown; }
+    void setThreat(int value) { threat = value; }
     
     // Combat engagement control
-    void setActiveCombatant(bool active) { isActiveCombatant = active; }
+    // Ignored while an arbiter hands out attack turns, it owns the flag then
+    void setActiveCombatant(bool active) { if (!arbiter) isActiveCombatant = active; }
     bool getIsActiveCombatant() const { return isActiveCombatant; }
     
+    // Arbitration: the arbiter calls these when this agent gains or loses an attack token
+    void setArbiter(CombatArbiter* combatArbiter);
+    void onAttackTokenGranted() override;
+    void onAttackTokenRevoked() override;
+    void onArbiterDestroyed() override;
+    
     // State accessors
     AIState getState() const { return currentState; }
     bool isEngaged() const { return currentState == AI_CHASE || currentState == AI_ATTACK; }
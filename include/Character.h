@@ -6,6 +6,8 @@
 #include <memory>
 #include "AnimatedSprite.h"
 
+class ParticleSystem;
+
 enum CharacterState {
     IDLE,
     WALKING,
@@ -15,14 +17,14 @@ enum CharacterState {
 
 class Character {
 private:
-    int x, y;
+    float x, y;  // sub-pixel position, movement is scaled by frame time
     bool facingRight;
     CharacterState currentState;
     std::map<CharacterState, std::unique_ptr<AnimatedSprite>> animations;
     
     // Character properties
-    const int SPRITE_SPEED = 5;
-    const int JUMP_SPEED = 8;
+    const float SPRITE_SPEED = 300.0f;  // pixels per second
+    const float JUMP_SPEED = 480.0f;    // pixels per second
     const int MAX_JUMP_HEIGHT = 100;
     
     // Movement tracking for jumping
@@ -30,7 +32,10 @@ private:
     
     // State variables
     bool isJumping;
-    int jumpHeight;
+    float jumpHeight;
+    
+    // Effects target, owned by Game
+    ParticleSystem* particles;
     
 public:
     // Constructor for character
@@ -38,22 +43,26 @@ public:
     ~Character();
     
     void handleEvents(const SDL_Event& event);
-    void update(const Uint8* keyState, int floorY);
+    void update(const Uint8* keyState, int floorY, float dt);
     void render(SDL_Renderer* renderer);
     
     // State management
     void setState(CharacterState state);
     CharacterState getState() const { return currentState; }
     bool isFacingRight() const { return facingRight; }
+    int getAnimationFrame() const { return animations.at(currentState)->getCurrentFrame(); }
+    
+    // Effects
+    void setParticleSystem(ParticleSystem* system) { particles = system; }
     
     // Movement methods
-    void moveLeft(int speed);
-    void moveRight(int speed);
+    void moveLeft(float distance);
+    void moveRight(float distance);
     void jump();
     
     // Position and properties
-    int getX() const { return x; }
-    int getY() const { return y; }
+    int getX() const { return static_cast<int>(x); }
+    int getY() const { return static_cast<int>(y); }
     void setX(int newX) { x = newX; }
     void setY(int newY) { y = newY; }
     int getWidth() const { return 128; } // Assuming character width is 128
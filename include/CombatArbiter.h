@@ -0,0 +1,118 @@
+#ifndef COMBAT_ARBITER_H
+#define COMBAT_ARBITER_H
+
+#include <SDL2/SDL.h>
+#include <map>
+#include <vector>
+
+// Forward declaration, targets are only used as keys
+class Character;
+
+// Receives attack token events from the arbiter. Implementations must not call
+// back into the arbiter from these.
+class AttackTokenListener {
+public:
+    virtual ~AttackTokenListener() {}
+    virtual void onAttackTokenGranted() = 0;
+    virtual void onAttackTokenRevoked() = 0;
+    
+    // The arbiter is being destroyed; drop any pointer to it
+    virtual void onArbiterDestroyed() = 0;
+};
+
+// Hands out a limited number of attack tokens per target. Agents waiting for a
+// token sit in a priority queue ordered by distance, threat and wait time; the
+// arbiter grants and revokes tokens by calling back into the listeners.
+// Listeners unregister themselves when destroyed; if the arbiter goes first it
+// notifies every registered listener through onArbiterDestroyed.
+class CombatArbiter {
+private:
+    struct Agent {
+        AttackTokenListener* listener;
+        Character* target;
+        int distance;
+        int threat;
+        Uint32 requestTime;  // when the agent joined the queue
+        Uint32 grantTime;    // when the agent got its token
+        bool holding;
+        int heapIndex;       // position in its target's waiting or holder heap, -1 if none
+    };
+
+    // Binary heap of agent slots; holders are kept worst-first so preemption is O(log N)
+    struct AgentHeap {
+        std::vector<int> slots;
+        bool worstFirst;
+    };
+
+    struct TargetQueue {
+        AgentHeap waiting;
+        AgentHeap holders;
+        Uint32 nextPreemptCheck;  // when the best waiter may overtake the worst holder, 0 if never
+
+        TargetQueue() : nextPreemptCheck(0) { waiting.worstFirst = false; holders.worstFirst = true; }
+    };
+
+    std::vector<Agent> agents;
+    std::vector<int> freeSlots;
+    std::map<AttackTokenListener*, int> slotLookup;
+    std::map<Character*, TargetQueue> targets;
+
+    // Arbitration parameters
+    int tokensPerTarget;
+    Uint32 minHoldTime;    // milliseconds a token is kept before it can be preempted
+    float distanceWeight;
+    float threatWeight;
+    float waitWeight;      // score per millisecond of waiting, or of holding a token
+    float preemptMargin;   // score advantage needed to take a token away
+
+    // Heap keys. They leave out the current time, which every agent shares, so
+    // they only change when an agent reports a new distance or threat.
+    double key(const Agent& agent) const;
+    double scoreAt(const Agent& agent, Uint32 currentTime) const;
+    bool before(const AgentHeap& heap, int a, int b) const;
+
+    // Heap maintenance
+    void heapPush(AgentHeap& heap, int slot);
+    void heapRemove(AgentHeap& heap, int slot);
+    void heapUpdate(AgentHeap& heap, int slot);
+    void siftUp(AgentHeap& heap, int index);
+    void siftDown(AgentHeap& heap, int index);
+    void heapSwap(AgentHeap& heap, int i, int j);
+
+    void grant(TargetQueue& queue, int slot, Uint32 currentTime);
+    void revoke(TargetQueue& queue, int slot, Uint32 currentTime);
+    void rebalance(TargetQueue& queue, Uint32 currentTime);
+    void schedulePreemptCheck(TargetQueue& queue);
+    void reheap(AgentHeap& heap);
+    void rescheduleAll();
+    void leaveQueue(int slot);
+
+public:
+    CombatArbiter(int tokensPerTarget = 2);  // negative counts are treated as 0
+    ~CombatArbiter();
+
+    // Registration
+    void registerAgent(AttackTokenListener* listener, Character* target);
+    void unregisterAgent(AttackTokenListener* listener, Uint32 currentTime);
+
+    // Agents call these from their own update; each is O(log N)
+    void requestToken(AttackTokenListener* listener, int distance, int threat, Uint32 currentTime);
+    void withdraw(AttackTokenListener* listener, Uint32 currentTime);
+    void releaseToken(AttackTokenListener* listener, Uint32 currentTime);
+
+    // Call once per frame; only targets with a preemption due do any work
+    void update(Uint32 currentTime);
+
+    // Configuration
+    void setTokensPerTarget(int tokens, Uint32 currentTime);
+    void setMinHoldTime(Uint32 time);
+    void setWeights(float distance, float threat, float wait, Uint32 currentTime);
+    void setPreemptMargin(float margin);
+
+    // Queries
+    bool holdsToken(AttackTokenListener* listener) const;
+    int getHolderCount(Character* target) const;
+    int getWaitingCount(Character* target) const;
+};
+
+#endif // COMBAT_ARBITER_H
@@ -0,0 +1,73 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <SDL2/SDL.h>
+
+enum FramePacingMode {
+    PACING_VSYNC,     // Present waits on vblank, input sampled right after it
+    PACING_UNCAPPED,  // No vsync, no sleeping
+    PACING_ADAPTIVE   // Vsync, but sleep before sampling input so the frame finishes just before vblank
+};
+
+// Latency summary in milliseconds
+struct FrameLatencyStats {
+    int samples;
+    double average;
+    double percentile99;
+    double worst;
+};
+
+class FramePacer {
+private:
+    FramePacingMode mode;
+    bool hardwareVSync;         // false if the renderer ignored the vsync request
+    double refreshPeriod;       // milliseconds per display refresh
+    double ticksPerMs;
+
+    // Frame cost prediction (exponential moving averages, milliseconds)
+    double averageCost;
+    double costDeviation;
+
+    // Timestamps of the current frame, in performance counter ticks
+    Uint64 lastPresentTime;
+    Uint64 inputSampleTime;
+    Uint64 submitTime;
+    Uint64 nextVBlank;          // software vblank used when hardware vsync is missing
+
+    // Ring buffer of recent input sample to present latencies, milliseconds
+    static const int HISTORY_SIZE = 1024;
+    float sampleLatency[HISTORY_SIZE];
+    int sampleCount;
+
+    double toMs(Uint64 ticks) const { return ticks / ticksPerMs; }
+    Uint64 toTicks(double ms) const { return static_cast<Uint64>(ms * ticksPerMs); }
+    double predictedCost() const;
+    void sleepUntil(Uint64 deadline);
+    void waitForTimedCap();
+    static FrameLatencyStats summarize(const float* history, int count);
+
+public:
+    static const int SAFETY_MARGIN_MS = 2;  // slack kept before the predicted vblank
+
+    FramePacer(FramePacingMode mode, int refreshRate, bool hardwareVSync);
+
+    // Call order per frame: beginFrame, input/update/render, beforePresent, present, endFrame
+    void beginFrame();
+    void beforePresent();
+    void endFrame();
+
+    // Whether to ask the renderer for vsync
+    static bool wantsVSync(FramePacingMode mode) { return mode != PACING_UNCAPPED; }
+    FramePacingMode getMode() const { return mode; }
+    double getPredictedCost() const { return predictedCost(); }
+
+    // Measured from the events/keyboard poll to present. SDL stamps events when it pumps
+    // them, so time a key spent in the OS queue before that is not visible here.
+    FrameLatencyStats getSampleLatency() const { return summarize(sampleLatency, sampleCount); }
+    void printReport() const;
+
+    static bool parseMode(const char* name, FramePacingMode& outMode);
+    static const char* modeName(FramePacingMode mode);
+};
+
+#endif // FRAME_PACER_H
@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include "Character.h"
+#include "ParticleSystem.h"
 
 class Game {
 private:
@@ -14,6 +15,12 @@ private:
     // Player character
     Character* player;
     
+    // Combat and movement effects
+    ParticleSystem* particles;
+    
+    // Whether the renderer actually honors SDL_RENDERER_PRESENTVSYNC
+    bool vsyncActive;
+    
     // Floor rendering
     SDL_Rect floorRect;
     const int FLOOR_Y = 400;
@@ -28,15 +35,18 @@ public:
     Game();
     ~Game();
     
-    bool init();
+    bool init(bool vsync = true);
     void handleEvents();
-    void update();
+    void update(float dt);
     void render();
+    void present();
     void clean();
     
     bool running() const { return isRunning; }
     SDL_Renderer* getRenderer() const { return renderer; }
     int getFloorY() const { return FLOOR_Y; }
+    int getRefreshRate() const;
+    bool hasVSync() const { return vsyncActive; }
 };
 
 #endif // GAME_H
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <vector>
+#include "Character.h"
+
+enum ParticleEffect {
+    EFFECT_DUST,
+    EFFECT_HIT_SPARK,
+    EFFECT_DEATH,
+    EFFECT_COUNT
+};
+
+// Fixed-capacity particle storage. Each attribute lives in its own array
+// (structure of arrays) so the update loop walks contiguous floats.
+class ParticlePool {
+public:
+    static const int FADE_BANDS = 4;
+
+private:
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> life, maxLife;
+    int capacity;
+    int count;
+
+    // Pool appearance and physics, shared by every particle in the pool
+    SDL_Color color;
+    int size;
+    float gravity;  // pixels per second squared
+    float drag;     // fraction of velocity kept per second
+
+    // Render batches, one per alpha band, allocated once
+    std::vector<SDL_Rect> batches[FADE_BANDS];
+
+public:
+    ParticlePool(int capacity, SDL_Color color, int size, float gravity, float drag);
+
+    bool spawn(float x, float y, float vx, float vy, float lifetime);
+    void update(float dt);
+    void render(SDL_Renderer* renderer);
+    void clear() { count = 0; }
+
+    int getCount() const { return count; }
+    int getCapacity() const { return capacity; }
+};
+
+// Fires a burst whenever its owner shows a given animation frame of a given state
+struct ParticleEmitter {
+    const Character* owner;
+    CharacterState state;
+    int frame;
+    ParticleEffect effect;
+    int burstCount;
+    int offsetX, offsetY;  // relative to the owner's sprite origin
+    int lastFrame;         // frame seen on the previous update, -1 if not in state
+};
+
+class ParticleSystem {
+private:
+    std::unique_ptr<ParticlePool> pools[EFFECT_COUNT];
+    std::vector<ParticleEmitter> emitters;
+    Uint32 randomState;
+
+    float randomRange(float low, float high);
+    void updateEmitters();
+
+public:
+    ParticleSystem();
+    ~ParticleSystem();
+
+    void update(float dt);
+    void render(SDL_Renderer* renderer);
+    void clear();
+
+    // Spawn a burst of the given effect; count is clamped to free pool space
+    void emit(ParticleEffect effect, int x, int y, int count, int direction = 0);
+
+    // Preset bursts used by characters
+    void emitLandingDust(int x, int y) { emit(EFFECT_DUST, x, y, 24); }
+    void emitHitSparks(int x, int y, int direction) { emit(EFFECT_HIT_SPARK, x, y, 32, direction); }
+    void emitDeathBurst(int x, int y) { emit(EFFECT_DEATH, x, y, 96); }
+
+    // Emitter management
+    void attachEmitter(const Character* owner, CharacterState state, int frame,
+                       ParticleEffect effect, int burstCount, int offsetX, int offsetY);
+    void detachEmitters(const Character* owner);
+
+    int getLiveCount() const;
+};
+
+#endif // PARTICLE_SYSTEM_H
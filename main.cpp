@@ -1,38 +1,64 @@
 #include "include/Game.h"
+#include "include/FramePacer.h"
+#include <cstring>
 #include <iostream>
 
-const int FPS = 60;
-const int FRAME_DELAY = 1000 / FPS;
+const float MAX_FRAME_TIME = 0.05f;  // seconds, longest step the simulation takes
+
+int main(int argc, char* argv[]) {
+    // Pick the frame pacing mode, e.g. ./game --pacing=adaptive
+    FramePacingMode pacingMode = PACING_ADAPTIVE;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--pacing=", 9) == 0 &&
+            !FramePacer::parseMode(argv[i] + 9, pacingMode)) {
+            std::cerr << "Unknown pacing mode " << argv[i] + 9
+                      << " (expected vsync, uncapped or adaptive)" << std::endl;
+            return 1;
+        }
+    }
 
-int main() {
     // Create game instance
     Game game;
-    
+
     // Initialize the game
-    if (!game.init()) {
+    if (!game.init(FramePacer::wantsVSync(pacingMode))) {
         std::cerr << "Failed to initialize game!" << std::endl;
         return 1;
     }
-    
-    // Game loop variables
-    Uint32 frameStart;
-    int frameTime;
-    
+
+    FramePacer pacer(pacingMode, game.getRefreshRate(), game.hasVSync());
+
+    // One simulation step per presented frame, scaled by the real time between frames,
+    // so game speed doesn't depend on the display and every frame uses fresh input
+    const double ticksPerSecond = static_cast<double>(SDL_GetPerformanceFrequency());
+    Uint64 lastFrameTime = SDL_GetPerformanceCounter();
+
     // Main game loop
     while (game.running()) {
-        frameStart = SDL_GetTicks();
-        
+        // Sleep first (adaptive mode) so input is as fresh as possible when presented
+        pacer.beginFrame();
+
         game.handleEvents();
-        game.update();
-        game.render();
-        
-        // Cap the frame rate
-        frameTime = SDL_GetTicks() - frameStart;
-        if (FRAME_DELAY > frameTime) {
-            SDL_Delay(FRAME_DELAY - frameTime);
+
+        // Clamp dt so a long stall doesn't teleport anything
+        Uint64 now = SDL_GetPerformanceCounter();
+        float dt = static_cast<float>((now - lastFrameTime) / ticksPerSecond);
+        lastFrameTime = now;
+        if (dt > MAX_FRAME_TIME) {
+            dt = MAX_FRAME_TIME;
         }
+        game.update(dt);
+
+        game.render();
+
+        pacer.beforePresent();
+        game.present();
+        pacer.endFrame();
     }
-    
+
+    // Report measured input latency
+    pacer.printReport();
+
     // Game is done
     return 0;
 }
@@ -1,5 +1,6 @@
 #include "../include/AIController.h"
 #include "../include/Character.h"
+#include "../include/CombatArbiter.h"
 #include <cmath>
 #include <iostream>
 #include <cstdlib>
@@ -9,6 +10,7 @@ AIController::AIController(Character* controlledCharacter, Character* player)
       playerCharacter(player),
       currentState(AI_IDLE),
       isActiveCombatant(false),
+      arbiter(nullptr),
       detectionRange(300),
       attackRange(80),
       patrolSpeed(2),
@@ -19,22 +21,68 @@ AIController::AIController(Character* controlledCharacter, Character* player)
       lastDecisionTime(SDL_GetTicks()),
       decisionDelay(1000), // Make decisions every 1 second
       lastAttackTime(0),
+      lastUpdateTime(SDL_GetTicks()),
       attackCooldown(1500), // 1.5 seconds between attacks
-      attackType(1)
+      attackType(1),
+      threat(1)
 {
     // Initialize with default patrol boundaries
 }
 
 AIController::~AIController() {
-    // No dynamic allocations to clean up
+    // Leave the arbiter so it doesn't keep a dangling listener
+    if (arbiter) {
+        arbiter->unregisterAgent(this, lastUpdateTime);
+    }
+}
+
+void AIController::setArbiter(CombatArbiter* combatArbiter) {
+    if (arbiter) {
+        arbiter->unregisterAgent(this, lastUpdateTime);
+    }
+    
+    arbiter = combatArbiter;
+    if (arbiter) {
+        arbiter->registerAgent(this, playerCharacter);
+    }
+}
+
+void AIController::onAttackTokenGranted() {
+    isActiveCombatant = true;
+    makeDecision();
+}
+
+void AIController::onAttackTokenRevoked() {
+    isActiveCombatant = false;
+    makeDecision();
+}
+
+void AIController::onArbiterDestroyed() {
+    arbiter = nullptr;
+    isActiveCombatant = false;
 }
 
 void AIController::update(Uint32 currentTime) {
+    lastUpdateTime = currentTime;
+    
     // Skip if character is dead
     if (character->getState() == DEAD) {
+        if (arbiter) {
+            arbiter->withdraw(this, currentTime);
+        }
         return;
     }
     
+    // Queue for an attack turn while the player is within detection range
+    if (arbiter) {
+        int distanceToPlayer = getDistanceToPlayer();
+        if (distanceToPlayer <= detectionRange) {
+            arbiter->requestToken(this, distanceToPlayer, threat, currentTime);
+        } else {
+            arbiter->withdraw(this, currentTime);
+        }
+    }
+    
     // Make decisions based on timers
     if (currentTime - lastDecisionTime > decisionDelay) {
         makeDecision();
@@ -152,6 +200,11 @@ void AIController::executeState(Uint32 currentTime) {
                 // Perform the attack
                 character->attack(attackType);
                 lastAttackTime = currentTime;
+                
+                // Hand the attack turn to the next enemy in line
+                if (arbiter) {
+                    arbiter->releaseToken(this, currentTime);
+                }
             }
             else if (!character->isInAttackRange(playerCharacter)) {
                 // If not in range, chase player
@@ -1,10 +1,12 @@
 #include "../include/Character.h"
 #include "../include/Game.h"
+#include "../include/ParticleSystem.h"
 #include <iostream>
 
 Character::Character(SDL_Renderer* renderer, int startX, int startY, int floorY)
     : x(startX), y(startY), facingRight(true), currentState(IDLE),
-      horizontalDirection(0), isJumping(false), jumpHeight(0)
+      horizontalDirection(0), isJumping(false), jumpHeight(0),
+      particles(nullptr)
 {
     // Load basic animations
     animations[IDLE] = std::make_unique<AnimatedSprite>(renderer, "assets/sprite.png", 128, 128, 5);
@@ -15,6 +17,11 @@ Character::Character(SDL_Renderer* renderer, int startX, int startY, int floorY)
 
 Character::~Character() {
     // AnimatedSprite instances are automatically cleaned up by unique_ptr
+    
+    // Don't leave emitters pointing at a destroyed character
+    if (particles) {
+        particles->detachEmitters(this);
+    }
 }
 
 void Character::handleEvents(const SDL_Event& event) {
@@ -25,7 +32,7 @@ void Character::handleEvents(const SDL_Event& event) {
     }
 }
 
-void Character::update(const Uint8* keyState, int floorY) {
+void Character::update(const Uint8* keyState, int floorY, float dt) {
     // Update the current animation
     animations[currentState]->update();
     
@@ -35,7 +42,7 @@ void Character::update(const Uint8* keyState, int floorY) {
     
     // Handle left/right movement - allow movement and direction change while jumping
     if (keyState[SDL_SCANCODE_LEFT]) { 
-        moveLeft(SPRITE_SPEED);
+        moveLeft(SPRITE_SPEED * dt);
         isMoving = true;
         horizontalDirection = -1;
         
@@ -49,7 +56,7 @@ void Character::update(const Uint8* keyState, int floorY) {
     }
     
     if (keyState[SDL_SCANCODE_RIGHT]) { 
-        moveRight(SPRITE_SPEED);
+        moveRight(SPRITE_SPEED * dt);
         isMoving = true;
         horizontalDirection = 1;
         
@@ -71,17 +78,22 @@ void Character::update(const Uint8* keyState, int floorY) {
     if (isJumping) {
         if (jumpHeight < MAX_JUMP_HEIGHT) {
             // Rising during jump
-            y -= JUMP_SPEED;
-            jumpHeight += JUMP_SPEED;
+            y -= JUMP_SPEED * dt;
+            jumpHeight += JUMP_SPEED * dt;
         } else if (y < floorY - 128) {
             // Falling back down
-            y += JUMP_SPEED;
+            y += JUMP_SPEED * dt;
             
             // Check if landed
             if (y >= floorY - 128) {
                 y = floorY - 128; // Snap to floor
                 isJumping = false;
                 
+                // Kick up dust at the feet
+                if (particles) {
+                    particles->emitLandingDust(getX() + getWidth() / 2, floorY);
+                }
+                
                 // Set appropriate state based on movement when landing
                 if (horizontalDirection != 0) {
                     if (keyState[SDL_SCANCODE_LSHIFT] || keyState[SDL_SCANCODE_RSHIFT]) {
@@ -102,7 +114,7 @@ void Character::update(const Uint8* keyState, int floorY) {
 }
 
 void Character::render(SDL_Renderer* renderer) {
-    animations[currentState]->render(renderer, x, y, !facingRight);
+    animations[currentState]->render(renderer, getX(), getY(), !facingRight);
 }
 
 void Character::setState(CharacterState state) {
@@ -112,13 +124,13 @@ void Character::setState(CharacterState state) {
     }
 }
 
-void Character::moveLeft(int speed) {
-    x -= speed;
+void Character::moveLeft(float distance) {
+    x -= distance;
     facingRight = false;
 }
 
-void Character::moveRight(int speed) {
-    x += speed;
+void Character::moveRight(float distance) {
+    x += distance;
     facingRight = true;
 }
 
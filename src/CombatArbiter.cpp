@@ -0,0 +1,349 @@
+#include "../include/CombatArbiter.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+CombatArbiter::CombatArbiter(int tokensPerTarget)
+    : tokensPerTarget(std::max(tokensPerTarget, 0)),
+      minHoldTime(2000),     // Keep a token for at least 2 seconds
+      distanceWeight(1.0f),
+      threatWeight(50.0f),
+      waitWeight(0.2f),      // Waiting 1 second is worth being 200 pixels closer
+      preemptMargin(150.0f)
+{
+}
+
+CombatArbiter::~CombatArbiter() {
+    // Listeners are owned elsewhere, just make sure none keep pointing at us
+    for (std::map<AttackTokenListener*, int>::iterator it = slotLookup.begin(); it != slotLookup.end(); ++it) {
+        it->first->onArbiterDestroyed();
+    }
+}
+
+double CombatArbiter::key(const Agent& agent) const {
+    double base = distanceWeight * agent.distance - threatWeight * agent.threat;
+
+    // Waiters improve by waitWeight per millisecond waited, holders get worse by the
+    // same amount per millisecond held. Subtracting the shared current time out of
+    // both leaves keys that don't change as time passes.
+    if (agent.holding) {
+        return base - waitWeight * static_cast<double>(agent.grantTime);
+    }
+    return base + waitWeight * static_cast<double>(agent.requestTime);
+}
+
+double CombatArbiter::scoreAt(const Agent& agent, Uint32 currentTime) const {
+    // Lower is better
+    double now = waitWeight * static_cast<double>(currentTime);
+    return agent.holding ? key(agent) + now : key(agent) - now;
+}
+
+bool CombatArbiter::before(const AgentHeap& heap, int a, int b) const {
+    double keyA = key(agents[a]);
+    double keyB = key(agents[b]);
+    return heap.worstFirst ? keyA > keyB : keyA < keyB;
+}
+
+void CombatArbiter::heapSwap(AgentHeap& heap, int i, int j) {
+    std::swap(heap.slots[i], heap.slots[j]);
+    agents[heap.slots[i]].heapIndex = i;
+    agents[heap.slots[j]].heapIndex = j;
+}
+
+void CombatArbiter::siftUp(AgentHeap& heap, int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!before(heap, heap.slots[index], heap.slots[parent])) {
+            break;
+        }
+        heapSwap(heap, index, parent);
+        index = parent;
+    }
+}
+
+void CombatArbiter::siftDown(AgentHeap& heap, int index) {
+    int size = static_cast<int>(heap.slots.size());
+    while (true) {
+        int left = index * 2 + 1;
+        int right = left + 1;
+        int best = index;
+
+        if (left < size && before(heap, heap.slots[left], heap.slots[best])) best = left;
+        if (right < size && before(heap, heap.slots[right], heap.slots[best])) best = right;
+        if (best == index) {
+            break;
+        }
+        heapSwap(heap, index, best);
+        index = best;
+    }
+}
+
+void CombatArbiter::heapPush(AgentHeap& heap, int slot) {
+    heap.slots.push_back(slot);
+    agents[slot].heapIndex = static_cast<int>(heap.slots.size()) - 1;
+    siftUp(heap, agents[slot].heapIndex);
+}
+
+void CombatArbiter::heapRemove(AgentHeap& heap, int slot) {
+    int index = agents[slot].heapIndex;
+    int last = static_cast<int>(heap.slots.size()) - 1;
+
+    if (index != last) {
+        heapSwap(heap, index, last);
+    }
+    heap.slots.pop_back();
+    agents[slot].heapIndex = -1;
+
+    // The moved element may belong higher or lower
+    if (index < static_cast<int>(heap.slots.size())) {
+        siftUp(heap, index);
+        siftDown(heap, agents[heap.slots[index]].heapIndex);
+    }
+}
+
+void CombatArbiter::heapUpdate(AgentHeap& heap, int slot) {
+    siftUp(heap, agents[slot].heapIndex);
+    siftDown(heap, agents[slot].heapIndex);
+}
+
+void CombatArbiter::reheap(AgentHeap& heap) {
+    // Rebuild after the keys changed wholesale (new weights)
+    for (int i = static_cast<int>(heap.slots.size()) / 2 - 1; i >= 0; i--) {
+        siftDown(heap, i);
+    }
+}
+
+void CombatArbiter::grant(TargetQueue& queue, int slot, Uint32 currentTime) {
+    Agent& agent = agents[slot];
+    heapRemove(queue.waiting, slot);
+    agent.holding = true;
+    agent.grantTime = currentTime;
+    heapPush(queue.holders, slot);
+
+    agent.listener->onAttackTokenGranted();
+}
+
+void CombatArbiter::revoke(TargetQueue& queue, int slot, Uint32 currentTime) {
+    Agent& agent = agents[slot];
+    heapRemove(queue.holders, slot);
+    agent.holding = false;
+
+    // Back of the line
+    agent.requestTime = currentTime;
+    heapPush(queue.waiting, slot);
+
+    agent.listener->onAttackTokenRevoked();
+}
+
+void CombatArbiter::rebalance(TargetQueue& queue, Uint32 currentTime) {
+    // Drop the worst holders if the token count was lowered
+    while (static_cast<int>(queue.holders.slots.size()) > tokensPerTarget) {
+        revoke(queue, queue.holders.slots[0], currentTime);
+    }
+
+    // Hand out free tokens to the best waiting agents
+    while (static_cast<int>(queue.holders.slots.size()) < tokensPerTarget && !queue.waiting.slots.empty()) {
+        grant(queue, queue.waiting.slots[0], currentTime);
+    }
+
+    // Swap out the worst holder while a waiting agent is clearly better
+    while (!queue.waiting.slots.empty() && !queue.holders.slots.empty()) {
+        int best = queue.waiting.slots[0];
+        int worst = queue.holders.slots[0];
+
+        if (scoreAt(agents[best], currentTime) + preemptMargin >= scoreAt(agents[worst], currentTime)) break;
+        if (currentTime - agents[worst].grantTime < minHoldTime) break;
+
+        revoke(queue, worst, currentTime);
+        grant(queue, best, currentTime);
+    }
+
+    schedulePreemptCheck(queue);
+}
+
+void CombatArbiter::schedulePreemptCheck(TargetQueue& queue) {
+    queue.nextPreemptCheck = 0;
+    if (queue.waiting.slots.empty() || queue.holders.slots.empty() || waitWeight <= 0.0f) {
+        return;
+    }
+
+    const Agent& best = agents[queue.waiting.slots[0]];
+    const Agent& worst = agents[queue.holders.slots[0]];
+
+    // The waiter overtakes once key(best) - w*t + margin < key(worst) + w*t
+    double crossover = (key(best) - key(worst) + preemptMargin) / (2.0 * waitWeight);
+    double holdExpiry = static_cast<double>(worst.grantTime) + minHoldTime;
+    double due = std::floor(std::max(crossover, holdExpiry)) + 1.0;
+
+    if (due >= 4294967295.0) {
+        return;  // Beyond the tick counter's range
+    }
+    queue.nextPreemptCheck = due < 1.0 ? 1 : static_cast<Uint32>(due);
+}
+
+void CombatArbiter::rescheduleAll() {
+    for (std::map<Character*, TargetQueue>::iterator it = targets.begin(); it != targets.end(); ++it) {
+        schedulePreemptCheck(it->second);
+    }
+}
+
+void CombatArbiter::leaveQueue(int slot) {
+    Agent& agent = agents[slot];
+    if (agent.heapIndex == -1) {
+        return;
+    }
+
+    TargetQueue& queue = targets[agent.target];
+    heapRemove(agent.holding ? queue.holders : queue.waiting, slot);
+}
+
+void CombatArbiter::registerAgent(AttackTokenListener* listener, Character* target) {
+    if (slotLookup.count(listener)) {
+        return;
+    }
+
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<int>(agents.size());
+        agents.push_back(Agent());
+    }
+
+    Agent agent = { listener, target, 0, 0, 0, 0, false, -1 };
+    agents[slot] = agent;
+    slotLookup[listener] = slot;
+}
+
+void CombatArbiter::unregisterAgent(AttackTokenListener* listener, Uint32 currentTime) {
+    std::map<AttackTokenListener*, int>::iterator it = slotLookup.find(listener);
+    if (it == slotLookup.end()) {
+        return;
+    }
+
+    // No callback here, the listener may already be going away
+    int slot = it->second;
+    leaveQueue(slot);
+    agents[slot].holding = false;
+    rebalance(targets[agents[slot].target], currentTime);
+
+    agents[slot].listener = nullptr;
+    slotLookup.erase(it);
+    freeSlots.push_back(slot);
+}
+
+void CombatArbiter::requestToken(AttackTokenListener* listener, int distance, int threat, Uint32 currentTime) {
+    std::map<AttackTokenListener*, int>::iterator it = slotLookup.find(listener);
+    if (it == slotLookup.end()) {
+        std::cerr << "CombatArbiter: token requested by unregistered agent" << std::endl;
+        return;
+    }
+
+    int slot = it->second;
+    Agent& agent = agents[slot];
+    TargetQueue& queue = targets[agent.target];
+
+    bool changed = agent.distance != distance || agent.threat != threat;
+    agent.distance = distance;
+    agent.threat = threat;
+
+    if (agent.heapIndex == -1) {
+        // Joining the queue
+        agent.requestTime = currentTime;
+        heapPush(queue.waiting, slot);
+    } else if (changed) {
+        heapUpdate(agent.holding ? queue.holders : queue.waiting, slot);
+    } else if (queue.nextPreemptCheck == 0 || currentTime < queue.nextPreemptCheck) {
+        return;  // Ordering unchanged and no preemption due yet
+    }
+
+    rebalance(queue, currentTime);
+}
+
+void CombatArbiter::withdraw(AttackTokenListener* listener, Uint32 currentTime) {
+    std::map<AttackTokenListener*, int>::iterator it = slotLookup.find(listener);
+    if (it == slotLookup.end() || agents[it->second].heapIndex == -1) {
+        return;
+    }
+
+    int slot = it->second;
+    Agent& agent = agents[slot];
+    bool wasHolding = agent.holding;
+
+    leaveQueue(slot);
+    agent.holding = false;
+    if (wasHolding) {
+        agent.listener->onAttackTokenRevoked();
+    }
+
+    rebalance(targets[agent.target], currentTime);
+}
+
+void CombatArbiter::releaseToken(AttackTokenListener* listener, Uint32 currentTime) {
+    std::map<AttackTokenListener*, int>::iterator it = slotLookup.find(listener);
+    if (it == slotLookup.end() || !agents[it->second].holding) {
+        return;
+    }
+
+    // Give the token up after attacking so others get a turn
+    TargetQueue& queue = targets[agents[it->second].target];
+    revoke(queue, it->second, currentTime);
+    rebalance(queue, currentTime);
+}
+
+void CombatArbiter::update(Uint32 currentTime) {
+    // Preemption depends on time, so re-check targets whose check has come due
+    for (std::map<Character*, TargetQueue>::iterator it = targets.begin(); it != targets.end(); ++it) {
+        TargetQueue& queue = it->second;
+        if (queue.nextPreemptCheck != 0 && currentTime >= queue.nextPreemptCheck) {
+            rebalance(queue, currentTime);
+        }
+    }
+}
+
+void CombatArbiter::setTokensPerTarget(int tokens, Uint32 currentTime) {
+    tokensPerTarget = std::max(tokens, 0);
+    for (std::map<Character*, TargetQueue>::iterator it = targets.begin(); it != targets.end(); ++it) {
+        rebalance(it->second, currentTime);
+    }
+}
+
+void CombatArbiter::setMinHoldTime(Uint32 time) {
+    minHoldTime = time;
+    rescheduleAll();
+}
+
+void CombatArbiter::setWeights(float distance, float threat, float wait, Uint32 currentTime) {
+    distanceWeight = distance;
+    threatWeight = threat;
+    waitWeight = wait;
+
+    // Every key changed, so restore heap order before arbitrating again
+    for (std::map<Character*, TargetQueue>::iterator it = targets.begin(); it != targets.end(); ++it) {
+        reheap(it->second.waiting);
+        reheap(it->second.holders);
+        rebalance(it->second, currentTime);
+    }
+}
+
+void CombatArbiter::setPreemptMargin(float margin) {
+    preemptMargin = margin;
+    rescheduleAll();
+}
+
+bool CombatArbiter::holdsToken(AttackTokenListener* listener) const {
+    std::map<AttackTokenListener*, int>::const_iterator it = slotLookup.find(listener);
+    return it != slotLookup.end() && agents[it->second].holding;
+}
+
+int CombatArbiter::getHolderCount(Character* target) const {
+    std::map<Character*, TargetQueue>::const_iterator it = targets.find(target);
+    return it == targets.end() ? 0 : static_cast<int>(it->second.holders.slots.size());
+}
+
+int CombatArbiter::getWaitingCount(Character* target) const {
+    std::map<Character*, TargetQueue>::const_iterator it = targets.find(target);
+    return it == targets.end() ? 0 : static_cast<int>(it->second.waiting.slots.size());
+}
@@ -0,0 +1,150 @@
+#include "../include/FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+FramePacer::FramePacer(FramePacingMode mode, int refreshRate, bool hardwareVSync)
+    : mode(mode),
+      hardwareVSync(hardwareVSync),
+      refreshPeriod(1000.0 / (refreshRate > 0 ? refreshRate : 60)),
+      ticksPerMs(SDL_GetPerformanceFrequency() / 1000.0),
+      averageCost(0.0),
+      costDeviation(0.0),
+      lastPresentTime(0),
+      inputSampleTime(0),
+      submitTime(0),
+      nextVBlank(0),
+      sampleCount(0)
+{
+}
+
+double FramePacer::predictedCost() const {
+    // Pessimistic estimate: mean plus a couple of deviations, never more than a full refresh
+    double cost = averageCost + 2.0 * costDeviation;
+    return std::min(std::max(cost, 1.0), refreshPeriod);
+}
+
+void FramePacer::sleepUntil(Uint64 deadline) {
+    // SDL_Delay is only millisecond accurate, so sleep coarsely and spin the last stretch
+    Uint64 now = SDL_GetPerformanceCounter();
+    while (now < deadline) {
+        double remaining = toMs(deadline - now);
+        if (remaining > 1.5) {
+            SDL_Delay(static_cast<Uint32>(remaining - 1.0));
+        }
+        now = SDL_GetPerformanceCounter();
+    }
+}
+
+void FramePacer::waitForTimedCap() {
+    // Stand-in for vsync: vblanks every refreshPeriod, resynced if we fall behind
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (nextVBlank == 0 || now > nextVBlank) {
+        nextVBlank = now;
+    }
+
+    // Adaptive mode wakes early enough to finish the frame by the vblank
+    double lead = mode == PACING_ADAPTIVE ? predictedCost() + SAFETY_MARGIN_MS : 0.0;
+    Uint64 leadTicks = toTicks(lead);
+    if (nextVBlank > now + leadTicks) {
+        sleepUntil(nextVBlank - leadTicks);
+    }
+
+    nextVBlank += toTicks(refreshPeriod);
+}
+
+void FramePacer::beginFrame() {
+    if (mode == PACING_UNCAPPED) {
+        // Nothing to wait for
+    } else if (!hardwareVSync) {
+        waitForTimedCap();
+    } else if (mode == PACING_ADAPTIVE && lastPresentTime != 0) {
+        // Wait until just enough time is left to build the frame before vblank
+        double wait = refreshPeriod - predictedCost() - SAFETY_MARGIN_MS;
+        if (wait > 0.0) {
+            sleepUntil(lastPresentTime + toTicks(wait));
+        }
+    }
+
+    inputSampleTime = SDL_GetPerformanceCounter();
+}
+
+void FramePacer::beforePresent() {
+    submitTime = SDL_GetPerformanceCounter();
+
+    // Update the cost prediction with this frame's input-to-submit time
+    double cost = toMs(submitTime - inputSampleTime);
+    if (averageCost == 0.0) {
+        averageCost = cost;
+    } else {
+        const double smoothing = 0.1;
+        costDeviation += smoothing * (std::fabs(cost - averageCost) - costDeviation);
+        averageCost += smoothing * (cost - averageCost);
+    }
+}
+
+void FramePacer::endFrame() {
+    // Present has returned; with vsync this is right after vblank
+    lastPresentTime = SDL_GetPerformanceCounter();
+
+    // Every frame simulates once with the input it sampled, so every frame is a sample
+    sampleLatency[sampleCount % HISTORY_SIZE] = static_cast<float>(toMs(lastPresentTime - inputSampleTime));
+    sampleCount++;
+}
+
+FrameLatencyStats FramePacer::summarize(const float* history, int count) {
+    FrameLatencyStats stats = { 0, 0.0, 0.0, 0.0 };
+    int n = std::min(count, static_cast<int>(HISTORY_SIZE));
+    if (n == 0) {
+        return stats;
+    }
+
+    float sorted[HISTORY_SIZE];
+    std::memcpy(sorted, history, n * sizeof(float));
+    std::sort(sorted, sorted + n);
+
+    double total = 0.0;
+    for (int i = 0; i < n; i++) {
+        total += sorted[i];
+    }
+
+    stats.samples = n;
+    stats.average = total / n;
+    stats.percentile99 = sorted[std::min(n - 1, (n * 99) / 100)];
+    stats.worst = sorted[n - 1];
+    return stats;
+}
+
+void FramePacer::printReport() const {
+    FrameLatencyStats input = getSampleLatency();
+
+    std::cout << "Frame pacing: " << modeName(mode)
+              << (mode != PACING_UNCAPPED && !hardwareVSync ? " (timed cap, no hardware vsync)" : "")
+              << ", predicted frame cost " << predictedCost() << " ms" << std::endl;
+    std::cout << "Input sample to present over " << input.samples << " frames: avg "
+              << input.average << " ms, p99 " << input.percentile99 << " ms, max "
+              << input.worst << " ms (excludes time queued before SDL polled it)" << std::endl;
+}
+
+bool FramePacer::parseMode(const char* name, FramePacingMode& outMode) {
+    if (std::strcmp(name, "vsync") == 0) {
+        outMode = PACING_VSYNC;
+    } else if (std::strcmp(name, "uncapped") == 0) {
+        outMode = PACING_UNCAPPED;
+    } else if (std::strcmp(name, "adaptive") == 0) {
+        outMode = PACING_ADAPTIVE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* FramePacer::modeName(FramePacingMode mode) {
+    switch (mode) {
+        case PACING_VSYNC:    return "vsync";
+        case PACING_UNCAPPED: return "uncapped";
+        case PACING_ADAPTIVE: return "adaptive";
+    }
+    return "unknown";
+}
@@ -2,7 +2,8 @@
 #include <iostream>
 
 Game::Game() 
-    : window(nullptr), renderer(nullptr), isRunning(false), player(nullptr) {
+    : window(nullptr), renderer(nullptr), isRunning(false), player(nullptr),
+      particles(nullptr), vsyncActive(false) {
     floorRect = { 0, FLOOR_Y, SCREEN_WIDTH, 50 };
 }
 
@@ -10,7 +11,7 @@ Game::~Game() {
     clean();
 }
 
-bool Game::init() {
+bool Game::init(bool vsync) {
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
@@ -28,13 +29,24 @@ bool Game::init() {
     }
 
     // Create renderer
-    renderer = SDL_CreateRenderer(window, -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+    if (vsync) {
+        rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    renderer = SDL_CreateRenderer(window, -1, rendererFlags);
 
     if (!renderer) {
         std::cerr << "CreateRenderer Error: " << SDL_GetError() << std::endl;
         return false;
     }
+    
+    // Some renderers (e.g. software) silently ignore the vsync flag
+    SDL_RendererInfo info;
+    vsyncActive = SDL_GetRendererInfo(renderer, &info) == 0 &&
+                  (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+    if (vsync && !vsyncActive) {
+        std::cerr << "Renderer does not support vsync, using a timed frame cap" << std::endl;
+    }
 
     // Initialize SDL_image
     if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
@@ -45,6 +57,10 @@ bool Game::init() {
     // Create player character
     player = new Character(renderer, 100, FLOOR_Y - 128, FLOOR_Y);
     
+    // Create particle system and hook the player up to it
+    particles = new ParticleSystem();
+    player->setParticleSystem(particles);
+    
     isRunning = true;
     return true;
 }
@@ -60,11 +76,15 @@ void Game::handleEvents() {
     }
 }
 
-void Game::update() {
+void Game::update(float dt) {
+    // Runs once per presented frame; dt is the real time since the previous one
     const Uint8* keyState = SDL_GetKeyboardState(NULL);
     
     // Update player
-    player->update(keyState, FLOOR_Y);
+    player->update(keyState, FLOOR_Y, dt);
+    
+    // Advance particles by the same step
+    particles->update(dt);
 }
 
 void Game::render() {
@@ -79,17 +99,36 @@ void Game::render() {
     // Render the player character
     player->render(renderer);
     
-    // Present the renderer
+    // Render particles on top of characters
+    particles->render(renderer);
+}
+
+void Game::present() {
+    // Kept separate from render so the frame pacer can time the submit
     SDL_RenderPresent(renderer);
 }
 
+int Game::getRefreshRate() const {
+    SDL_DisplayMode mode;
+    if (SDL_GetWindowDisplayMode(window, &mode) != 0 || mode.refresh_rate <= 0) {
+        return 60;  // Unknown, assume the common case
+    }
+    return mode.refresh_rate;
+}
+
 void Game::clean() {
-    // Clean up player
+    // Clean up player first, its destructor detaches emitters from the particle system
     if (player) {
         delete player;
         player = nullptr;
     }
     
+    // Clean up particles
+    if (particles) {
+        delete particles;
+        particles = nullptr;
+    }
+    
     if (renderer) {
         SDL_DestroyRenderer(renderer);
         renderer = nullptr;
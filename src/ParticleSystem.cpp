@@ -0,0 +1,228 @@
+#include "../include/ParticleSystem.h"
+#include "../include/Character.h"
+#include <algorithm>
+#include <cmath>
+
+ParticlePool::ParticlePool(int capacity, SDL_Color color, int size, float gravity, float drag)
+    : capacity(capacity), count(0), color(color), size(size),
+      gravity(gravity), drag(drag)
+{
+    // All storage is reserved up front so spawning never allocates
+    posX.resize(capacity);
+    posY.resize(capacity);
+    velX.resize(capacity);
+    velY.resize(capacity);
+    life.resize(capacity);
+    maxLife.resize(capacity);
+
+    for (int band = 0; band < FADE_BANDS; band++) {
+        batches[band].reserve(capacity);
+    }
+}
+
+bool ParticlePool::spawn(float x, float y, float vx, float vy, float lifetime) {
+    if (count >= capacity) {
+        return false;
+    }
+
+    posX[count] = x;
+    posY[count] = y;
+    velX[count] = vx;
+    velY[count] = vy;
+    life[count] = lifetime;
+    maxLife[count] = lifetime;
+    count++;
+    return true;
+}
+
+// Integrate every particle. The arrays never overlap and there are no branches, so
+// the compiler vectorizes this at -O3 without runtime alias checks.
+static void integrateParticles(float* __restrict px, float* __restrict py,
+                               float* __restrict vx, float* __restrict vy,
+                               float* __restrict lf, int count,
+                               float dragFactor, float gravityStep, float dt) {
+    for (int i = 0; i < count; i++) {
+        vx[i] *= dragFactor;
+        vy[i] = vy[i] * dragFactor + gravityStep;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        lf[i] -= dt;
+    }
+}
+
+void ParticlePool::update(float dt) {
+    float* px = posX.data();
+    float* py = posY.data();
+    float* vx = velX.data();
+    float* vy = velY.data();
+    float* lf = life.data();
+
+    integrateParticles(px, py, vx, vy, lf, count, std::pow(drag, dt), gravity * dt, dt);
+
+    // Remove expired particles by moving the last live one into their slot
+    int i = 0;
+    while (i < count) {
+        if (lf[i] <= 0.0f) {
+            count--;
+            px[i] = px[count];
+            py[i] = py[count];
+            vx[i] = vx[count];
+            vy[i] = vy[count];
+            lf[i] = lf[count];
+            maxLife[i] = maxLife[count];
+        } else {
+            i++;
+        }
+    }
+}
+
+void ParticlePool::render(SDL_Renderer* renderer) {
+    if (count == 0) {
+        return;
+    }
+
+    for (int band = 0; band < FADE_BANDS; band++) {
+        batches[band].clear();
+    }
+
+    // Sort particles into alpha bands by remaining life
+    const int half = size / 2;
+    for (int i = 0; i < count; i++) {
+        int band = static_cast<int>(life[i] / maxLife[i] * FADE_BANDS);
+        band = std::min(std::max(band, 0), FADE_BANDS - 1);
+
+        SDL_Rect rect = { static_cast<int>(posX[i]) - half, static_cast<int>(posY[i]) - half, size, size };
+        batches[band].push_back(rect);
+    }
+
+    // One draw call per band
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    for (int band = 0; band < FADE_BANDS; band++) {
+        if (batches[band].empty()) {
+            continue;
+        }
+
+        Uint8 alpha = static_cast<Uint8>(color.a * (band + 1) / FADE_BANDS);
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, alpha);
+        SDL_RenderFillRects(renderer, batches[band].data(), static_cast<int>(batches[band].size()));
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+ParticleSystem::ParticleSystem()
+    : randomState(0x9E3779B9u)
+{
+    // Capacity, color, size, gravity, drag per effect
+    pools[EFFECT_DUST] = std::make_unique<ParticlePool>(8192, SDL_Color{ 160, 130, 95, 200 }, 4, 150.0f, 0.2f);
+    pools[EFFECT_HIT_SPARK] = std::make_unique<ParticlePool>(16384, SDL_Color{ 255, 220, 90, 255 }, 3, 600.0f, 0.05f);
+    pools[EFFECT_DEATH] = std::make_unique<ParticlePool>(8192, SDL_Color{ 150, 20, 20, 230 }, 5, 400.0f, 0.3f);
+}
+
+ParticleSystem::~ParticleSystem() {
+    // Pools are automatically cleaned up by unique_ptr
+}
+
+float ParticleSystem::randomRange(float low, float high) {
+    // xorshift32, cheaper than rand() for large bursts
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return low + (high - low) * (randomState & 0xFFFFFF) / 16777216.0f;
+}
+
+void ParticleSystem::update(float dt) {
+    updateEmitters();
+
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        pools[i]->update(dt);
+    }
+}
+
+void ParticleSystem::render(SDL_Renderer* renderer) {
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        pools[i]->render(renderer);
+    }
+}
+
+void ParticleSystem::clear() {
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        pools[i]->clear();
+    }
+}
+
+void ParticleSystem::emit(ParticleEffect effect, int x, int y, int count, int direction) {
+    ParticlePool* pool = pools[effect].get();
+
+    for (int i = 0; i < count; i++) {
+        float vx, vy, lifetime;
+
+        switch (effect) {
+            case EFFECT_DUST:
+                // Low puff spreading sideways along the floor
+                vx = randomRange(-120.0f, 120.0f);
+                vy = randomRange(-60.0f, -10.0f);
+                lifetime = randomRange(0.3f, 0.6f);
+                break;
+
+            case EFFECT_HIT_SPARK:
+                // Fast sparks thrown in the hit direction, or all around if none
+                vx = direction != 0 ? direction * randomRange(150.0f, 450.0f) : randomRange(-300.0f, 300.0f);
+                vy = randomRange(-250.0f, 100.0f);
+                lifetime = randomRange(0.15f, 0.35f);
+                break;
+
+            case EFFECT_DEATH:
+            default:
+                // Slower, longer-lived burst
+                vx = randomRange(-200.0f, 200.0f);
+                vy = randomRange(-300.0f, -50.0f);
+                lifetime = randomRange(0.6f, 1.2f);
+                break;
+        }
+
+        if (!pool->spawn(static_cast<float>(x), static_cast<float>(y), vx, vy, lifetime)) {
+            break;  // Pool is full
+        }
+    }
+}
+
+void ParticleSystem::attachEmitter(const Character* owner, CharacterState state, int frame,
+                                   ParticleEffect effect, int burstCount, int offsetX, int offsetY) {
+    ParticleEmitter emitter = { owner, state, frame, effect, burstCount, offsetX, offsetY, -1 };
+    emitters.push_back(emitter);
+}
+
+void ParticleSystem::detachEmitters(const Character* owner) {
+    emitters.erase(std::remove_if(emitters.begin(), emitters.end(),
+                                  [owner](const ParticleEmitter& e) { return e.owner == owner; }),
+                   emitters.end());
+}
+
+void ParticleSystem::updateEmitters() {
+    for (ParticleEmitter& emitter : emitters) {
+        if (emitter.owner->getState() != emitter.state) {
+            emitter.lastFrame = -1;
+            continue;
+        }
+
+        // Fire once when the animation reaches the trigger frame
+        int frame = emitter.owner->getAnimationFrame();
+        if (frame == emitter.frame && emitter.lastFrame != frame) {
+            // Mirror the offset when the owner faces left
+            int offsetX = emitter.owner->isFacingRight() ? emitter.offsetX
+                                                         : emitter.owner->getWidth() - emitter.offsetX;
+            int direction = emitter.owner->isFacingRight() ? 1 : -1;
+            emit(emitter.effect, emitter.owner->getX() + offsetX,
+                 emitter.owner->getY() + emitter.offsetY, emitter.burstCount, direction);
+        }
+        emitter.lastFrame = frame;
+    }
+}
+
+int ParticleSystem::getLiveCount() const {
+    int total = 0;
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        total += pools[i]->getCount();
+    }
+    return total;
+}